@@ -14,11 +14,15 @@ Includes:
 #include <cstdlib>
 #include <ctime>
 #include <fstream>
+#include <bitset>
+#include <thread>
+#include <algorithm>
+#include <numeric>
 
 // to make syntax Unreal-friendly
 #define TMap std::map
 
-FBullCowGame::FBullCowGame() { Reset(); }; // default constructor
+FBullCowGame::FBullCowGame() : RandomEngine(time(NULL)), HintCache(std::make_shared<FHintCache>()) { Reset(); }; // default constructor
 
 // getters
 int32 FBullCowGame::GetCurrentTry() const { return MyCurrentTry; };
@@ -27,6 +31,15 @@ bool FBullCowGame::GetIsGameWon() const { return bMyGameWon; };
 int32 FBullCowGame::GetMinWordLength() const { return MinNumberOfLetters; };
 int32 FBullCowGame::GetMaxWordLength() const { return MaxNumberOfLetters; };
 FGameStats FBullCowGame::GetGameStats() const { return GameStats; };
+FHintCacheStats FBullCowGame::GetHintCacheStats() const { return HintCache->GetStats(); };
+EHostMode FBullCowGame::GetHostMode() const { return HostMode; };
+EWordSelection FBullCowGame::GetWordSelection() const { return WordSelection; };
+
+// setters
+void FBullCowGame::SetHintCacheBudget(uint64 Bytes) { HintCache->SetMemoryBudget(Bytes); };
+void FBullCowGame::SetHintCache(std::shared_ptr<FHintCache> Cache) { if (Cache) { HintCache = Cache; }; }; // eg. one cache for every game in the process
+void FBullCowGame::SetHostMode(EHostMode Mode) { HostMode = Mode; }; // takes effect from the next SetHiddenWord
+void FBullCowGame::SetWordSelection(EWordSelection Selection) { WordSelection = Selection; }; // takes effect from the next SetHiddenWord
 
 
 // methods
@@ -34,9 +47,14 @@ FGameStats FBullCowGame::GetGameStats() const { return GameStats; };
 EFileReadStatus FBullCowGame::LoadWordList(FString Filename)
 /*
 Load list of words from filename provided (assumes one isogram per line)
-Adds each word to a Deque for each word-length of a TMap
-Using a TMap for the master structure so I can get a dictionary of appropriate isograms using MasterWordList[NumberOfLetters].WordList
-Using a Deque for the WordList so I can add an unknown number of words to the list and count them and return them by index
+Adds each word (packed) to the FWordList for its word-length in a TMap
+Using a TMap for the master structure so I can get a dictionary of appropriate isograms using MasterWordList[NumberOfLetters]
+Using vectors in the FWordList so I can add an unknown number of words to the list and count them and return them by index
+A line may give the word's weight after a tab (eg. "planet<tab>1234"), otherwise the file is taken
+to be in order of frequency and the weight is 1/rank within the word's own word-length
+(the file may be sorted by length first, so rank across the whole file would flatten longer words); alias tables for weighted picks are built at the end
+The new words are built separately and only replace the current ones once the whole file has loaded,
+so on any error the game keeps the dictionary it had
 Returns status of various types if there are problems reading the file or the content is unexpected
 */
 {
@@ -48,15 +66,35 @@ Returns status of various types if there are problems reading the file or the co
 		std::ifstream myfile(Filename);
 		if (myfile.is_open())
 		{
+			TMap<int32, FWordList> NewWordList;
 			// file is found and can be opened - start reading
 			while (getline(myfile, ReadLine))
 			{
+				double FileWeight = 0;
+				size_t Tab = ReadLine.find('\t');
+				if (Tab != FString::npos)
+				{
+					// use the weight from the file if it makes sense, otherwise stick with the rank
+					try {
+						FileWeight = stod(ReadLine.substr(Tab + 1));
+					}
+					catch (...) {};
+					ReadLine.erase(Tab);
+				};
 				LineLength = ReadLine.length();
 				if (LineLength >= ABSOLUTE_MIN_NUMBER_OF_LETTERS && LineLength <= ABSOLUTE_MAX_NUMBER_OF_LETTERS) 
 				{
-					// Add the word to the appropriate Deque of the appropriate TMap
+					// Add the word to the appropriate FWordList of the appropriate TMap
 					// ie. MasterWordList { { 3, {"the","and","but",...}}, { 4, {"plan", "done", ...}}, ... etc } 
-					MasterWordList[LineLength].WordList.push_back(ReadLine);					
+					FWordList& Dictionary = NewWordList[LineLength];
+					int32 Rank = Dictionary.PackedWords.size() + 1;
+					double Weight = (FileWeight > 0) ? FileWeight : 1.0 / Rank;
+					uint64 PackedWord;
+					uint32 LetterMask;
+					PackWord(ReadLine, PackedWord, LetterMask);
+					Dictionary.PackedWords.push_back(PackedWord);
+					Dictionary.LetterMasks.push_back(LetterMask);
+					Dictionary.Weights.push_back(Weight);
 					if (MinLineLength == 0 || LineLength < MinLineLength) { MinLineLength = LineLength; };
 					if (MaxLineLength == 0 || LineLength > MaxLineLength) { MaxLineLength = LineLength; };
 				};
@@ -69,7 +107,13 @@ Returns status of various types if there are problems reading the file or the co
 			}
 			else
 			{
-				// file has been read and words are just right
+				// file has been read and words are just right, so swap them in for the current ones
+				// no need to clear the hint cache: its keys include the dictionary's ContentHash,
+				// so entries for the old list are never matched and just age out
+				for (auto& Entry : NewWordList) { BuildAliasTables(Entry.second); };
+				SharedDictionary.Detach();
+				MasterWordList.swap(NewWordList);
+				UpdateDictionaries();
 				MinNumberOfLetters = MinLineLength;
 				MaxNumberOfLetters = MaxLineLength;
 				return EFileReadStatus::OK;
@@ -88,6 +132,90 @@ Returns status of various types if there are problems reading the file or the co
 }; // LoadWordList
 
 
+EFileReadStatus FBullCowGame::LoadWordListReference(FString Filename, TMap<int32, std::deque<FString>>& OutWordLists) const
+/*
+private function with the original loader, reading each word into a Deque for its word-length
+kept as the reference that LoadWordList is checked against (see VerifyWordList)
+The only change is dropping a weight after a tab, since the file format now allows one
+*/
+{
+	FString ReadLine;
+	int32 LineLength;
+	OutWordLists.clear();
+	try {
+		std::ifstream myfile(Filename);
+		if (myfile.is_open())
+		{
+			// file is found and can be opened - start reading
+			while (getline(myfile, ReadLine))
+			{
+				size_t Tab = ReadLine.find('\t');
+				if (Tab != FString::npos) { ReadLine.erase(Tab); };
+				LineLength = ReadLine.length();
+				if (LineLength >= ABSOLUTE_MIN_NUMBER_OF_LETTERS && LineLength <= ABSOLUTE_MAX_NUMBER_OF_LETTERS)
+				{
+					// Add the word to the appropriate Deque of the appropriate TMap
+					OutWordLists[LineLength].push_back(ReadLine);
+				};
+			};
+			myfile.close();
+			return EFileReadStatus::OK;
+		}
+		else
+		{
+			// file is found but cannot be opened so return error
+			return EFileReadStatus::File_Not_Opened;
+		};
+	}
+	catch (...) {
+		// file cannot be found or some other error
+		return EFileReadStatus::File_Not_Found;
+	};
+}; // LoadWordListReference
+
+
+EFileReadStatus FBullCowGame::LoadSharedWordList(FString Filename, FString SegmentName)
+/*
+Like LoadWordList, but every process using the same SegmentName (eg. "/bullcow-isograms") shares one read-only copy
+- if another process has already published the dictionary then just attach to it
+- otherwise load the file as normal, publish it and switch over to the shared copy (freeing this process's own)
+A segment built from a different version of the file is replaced
+Falls back to this process's own copy if shared memory can't be used
+*/
+{
+	uint64 SourceIdentity = FSharedDictionary::GetFileIdentity(Filename);
+	if (SourceIdentity == 0)
+	{
+		// can't tell which version of the file a segment holds, so don't share (and report the file problem)
+		return LoadWordList(Filename);
+	};
+	if (SharedDictionary.Attach(SegmentName, SourceIdentity))
+	{
+		MasterWordList.clear();
+		UpdateDictionaries();
+		return EFileReadStatus::OK;
+	};
+	// Attach lets go of any segment we were already using, so stop the views pointing into it
+	UpdateDictionaries();
+
+	EFileReadStatus FileStatus = LoadWordList(Filename);
+	if (FileStatus != EFileReadStatus::OK) { return FileStatus; };
+	// if another process beat us to creating it then attach to theirs instead
+	if (SharedDictionary.Create(SegmentName, Dictionaries, SourceIdentity) || SharedDictionary.Attach(SegmentName, SourceIdentity))
+	{
+		MasterWordList.clear();
+		UpdateDictionaries();
+	};
+	return EFileReadStatus::OK;
+}; // LoadSharedWordList
+
+
+bool FBullCowGame::IsUsingSharedWordList() const
+{
+	return SharedDictionary.IsAttached();
+}; // IsUsingSharedWordList
+
+
 FWordLength FBullCowGame::IsValidWordLength(FString Word) const
 /* 
 Check if user request for word length is valid
@@ -130,10 +258,27 @@ Returns error status if word length fails any of the checks or returns OK and th
 void FBullCowGame::SetHiddenWord(int32 NumberOfLetters) 
 /* 
 Sets the hidden word as a random word from the dictionary of isograms with that word length
+Picks uniformly or, depending on WordSelection, weighted by how common words are and/or from one tier only
+For the Evil host every word of that length stays possible and Reset picks a provisional word
 */
 {
-	int32 Number = GetRandomNumber(MasterWordList[NumberOfLetters].WordList.size());
-	MyHiddenWord = MasterWordList[NumberOfLetters].WordList[Number];
+	if (HostMode == EHostMode::Evil)
+	{
+		MyHiddenWord = UnpackWord(GetDictionary(NumberOfLetters).PackedWords[0], NumberOfLetters);
+		Reset();
+		return;
+	};
+	const FDictionaryView& Dictionary = GetDictionary(NumberOfLetters);
+	int32 Number;
+	if (WordSelection != EWordSelection::Uniform)
+	{
+		Number = PickWeightedWord(Dictionary.AliasTables[static_cast<int32>(WordSelection)]);
+	}
+	else
+	{
+		Number = GetRandomNumber(Dictionary.NumberOfWords);
+	};
+	MyHiddenWord = UnpackWord(Dictionary.PackedWords[Number], NumberOfLetters);
 	return;
 }; // SetHiddenWord
 
@@ -177,6 +322,20 @@ void FBullCowGame::Reset()
 {
 	MyCurrentTry = 1;
 	bMyGameWon = false;
+	GuessHistory.clear();
+	LiveCandidates.clear();
+	if (HostMode == EHostMode::Evil)
+	{
+		// nothing guessed yet so every word of this length is still live
+		int32 WordLen = GetHiddenWordLength();
+		const FDictionaryView& Dictionary = GetDictionary(WordLen);
+		if (Dictionary.NumberOfWords > 0)
+		{
+			LiveCandidates.reserve(Dictionary.NumberOfWords);
+			for (int32 Index = 0; Index < Dictionary.NumberOfWords; Index++) { LiveCandidates.push_back(Index); };
+			MyHiddenWord = UnpackWord(Dictionary.PackedWords[0], WordLen);
+		};
+	};
 	return;
 }; // Reset
 
@@ -187,41 +346,102 @@ Receives valid guess, increments turn and returns count of Bulls or Cows
 */
 {
 	MyCurrentTry++;
-	FBullCowCount MyBullCowCount;
+	FBullCowCount MyBullCowCount = (HostMode == EHostMode::Evil) ? SubmitEvilGuess(ThisGuess) : ScoreGuess(ThisGuess, MyHiddenWord);
+	GuessHistory.push_back(FGuessRecord{ ThisGuess, MyBullCowCount });
 
-	// loop through all letters in the guess
-	int32 WordLen = MyHiddenWord.length();
-	for (int32 GuessChr = 0; GuessChr < WordLen; GuessChr++)
-	{
-		// compare letters against the hidden word
-		for (int32 HiddenWordChr = 0; HiddenWordChr < WordLen; HiddenWordChr++) 
-		{
-			// if there is any match then
-			if (ThisGuess[HiddenWordChr] == MyHiddenWord[GuessChr]) 
-			{
-				if (HiddenWordChr == GuessChr) 
-				{
-					// increment bulls if they're in the same place
-					MyBullCowCount.Bulls++;
-				}
-				else 
-				{
-					// else increment cows if they're in the word but not in the same place
-					MyBullCowCount.Cows++;
-				};
-			}
-			else 
-			{
-				// else no match; no bulls, no cows
-			};
-		}; // next hiddenword
-	}; // next guess
 	// if all bulls then set game as won!
-	if (MyBullCowCount.Bulls == WordLen) { bMyGameWon = true; };
+	if (MyBullCowCount.Bulls == GetHiddenWordLength()) { bMyGameWon = true; };
 	return MyBullCowCount;
 }; // SubmitValidGuess
 
 
+FBullCowCount FBullCowGame::SubmitEvilGuess(const FString& ThisGuess)
+/*
+private function for the Evil host's response to a guess
+Partitions the live words by the Bulls and Cows each would give, keeps the largest partition
+and returns its response, so the player learns as little as possible
+Only gives all bulls when that is the only response left
+*/
+{
+	const int32 NUMBER_OF_RESPONSES = (ABSOLUTE_MAX_NUMBER_OF_LETTERS + 1) * (ABSOLUTE_MAX_NUMBER_OF_LETTERS + 1);
+	int32 WordLen = GetHiddenWordLength();
+	const FDictionaryView& Dictionary = GetDictionary(WordLen);
+	uint64 PackedGuess;
+	uint32 GuessMask;
+	PackWord(ThisGuess, PackedGuess, GuessMask);
+
+	// score every live word once, remembering its response for the filter below
+	int32 PartitionSize[NUMBER_OF_RESPONSES] = {};
+	int32 LiveCount = LiveCandidates.size();
+	CandidateResponses.resize(LiveCount);
+	for (int32 Live = 0; Live < LiveCount; Live++)
+	{
+		int32 Index = LiveCandidates[Live];
+		FBullCowCount Count = ScoreGuess(PackedGuess, GuessMask, Dictionary.PackedWords[Index], Dictionary.LetterMasks[Index], WordLen);
+		unsigned char Response = Count.Bulls * (ABSOLUTE_MAX_NUMBER_OF_LETTERS + 1) + Count.Cows;
+		CandidateResponses[Live] = Response;
+		PartitionSize[Response]++;
+	};
+
+	// pick the biggest partition; ties go to fewer bulls then fewer cows
+	int32 WinningResponse = WordLen * (ABSOLUTE_MAX_NUMBER_OF_LETTERS + 1);
+	int32 ChosenResponse = WinningResponse;
+	int32 ChosenSize = 0;
+	for (int32 Response = 0; Response < NUMBER_OF_RESPONSES; Response++)
+	{
+		if (Response != WinningResponse && PartitionSize[Response] > ChosenSize)
+		{
+			ChosenResponse = Response;
+			ChosenSize = PartitionSize[Response];
+		};
+	};
+
+	// keep only the words in the chosen partition (in dictionary order)
+	int32 Kept = 0;
+	for (int32 Live = 0; Live < LiveCount; Live++)
+	{
+		if (CandidateResponses[Live] == ChosenResponse) { LiveCandidates[Kept++] = LiveCandidates[Live]; };
+	};
+	LiveCandidates.resize(Kept);
+	if (Kept > 0) { MyHiddenWord = UnpackWord(Dictionary.PackedWords[LiveCandidates[0]], WordLen); };
+
+	FBullCowCount MyBullCowCount;
+	MyBullCowCount.Bulls = ChosenResponse / (ABSOLUTE_MAX_NUMBER_OF_LETTERS + 1);
+	MyBullCowCount.Cows = ChosenResponse % (ABSOLUTE_MAX_NUMBER_OF_LETTERS + 1);
+	return MyBullCowCount;
+}; // SubmitEvilGuess
+
+
+FString FBullCowGame::GetHint()
+/*
+Suggests a next guess that is consistent with every response given so far this game
+The word list is in order of how common the words are, so this picks the most common word still possible
+Returns an empty string if no hidden word has been set
+*/
+{
+	FCandidateSet Candidates = GetCandidates(GuessHistory.size());
+	const FDictionaryView& Dictionary = GetDictionary(GetHiddenWordLength());
+	for (size_t Block = 0; Block < Candidates.Bits.size(); Block++)
+	{
+		if (Candidates.Bits[Block] == 0) { continue; };
+		for (int32 Bit = 0; Bit < 64; Bit++)
+		{
+			if (Candidates.Bits[Block] & (uint64(1) << Bit)) { return UnpackWord(Dictionary.PackedWords[Block * 64 + Bit], GetHiddenWordLength()); };
+		};
+	};
+	return "";
+}; // GetHint
+
+
+int32 FBullCowGame::GetRemainingCandidateCount()
+/*
+Number of words in the dictionary that could still be the hidden word given the responses so far
+*/
+{
+	return GetCandidates(GuessHistory.size()).Count;
+}; // GetRemainingCandidateCount
+
+
 void FBullCowGame::UpdateTotalGames()
 {
 	GameStats.TotalGames++;
@@ -257,6 +477,29 @@ bool FBullCowGame::IsIsogram(FString Word) const
 /*
 private function to check if Word is valid isogram
 */
+{
+	// one bit per possible character rather than a map
+	std::bitset<256> LetterSeen;
+
+	// loop through letters within Word
+	for (auto letter : Word) {
+		unsigned char Lower = tolower(static_cast<unsigned char>(letter)); // ensure letter is lower-case
+		if (LetterSeen[Lower]) {
+			// if already seen then immediately return that this word isn't an isogram
+			return false;
+		};
+		LetterSeen[Lower] = true;
+	}
+	// when loop finished then we know all letters only seen once so the word is an isogram
+	return true;
+};  // isIsogram
+
+
+bool FBullCowGame::IsIsogramReference(FString Word) const
+/*
+private function with the original map-based isogram check
+kept as the reference that IsIsogram is checked against (see VerifyKernels)
+*/
 {
 	// treat 0 and 1 length word as isogram
 	if (Word.length() <= 1) { return true; };
@@ -277,7 +520,7 @@ private function to check if Word is valid isogram
 	}
 	// when loop finished then we know all letters only mapped once so the word is an isogram
 	return true;
-};  // isIsogram
+};  // IsIsogramReference
 
 
 bool FBullCowGame::IsLowercase(FString Word) const
@@ -318,6 +561,319 @@ private function to check if Word is valid integer
 }; // IsInteger
 
 
+FBullCowCount FBullCowGame::ScoreGuess(const FString& Guess, const FString& Word) const
+/*
+private function to count Bulls and Cows for a guess against any word of the same length
+*/
+{
+	uint64 PackedGuess, PackedWord;
+	uint32 GuessMask, WordMask;
+	PackWord(Guess, PackedGuess, GuessMask);
+	PackWord(Word, PackedWord, WordMask);
+	return ScoreGuess(PackedGuess, GuessMask, PackedWord, WordMask, Word.length());
+}; // ScoreGuess
+
+
+FBullCowCount FBullCowGame::ScoreGuess(uint64 PackedGuess, uint32 GuessMask, uint64 PackedWord, uint32 WordMask, int32 WordLen) const
+/*
+private function for the fast Bulls and Cows count on packed words (see PackWord)
+- Bulls are the bytes that are equal in both words
+- Cows are the letters common to both words, less the Bulls
+Only exact for words of distinct a-z letters, so anything else goes to the reference implementation
+*/
+{
+	if ((GuessMask | WordMask) & NOT_SIMPLE_LETTERS)
+	{
+		return ScoreGuessReference(UnpackWord(PackedGuess, WordLen), UnpackWord(PackedWord, WordLen));
+	};
+	const uint64 LOW_SEVEN_BITS = 0x7F7F7F7F7F7F7F7FULL;
+	// set the top bit of each byte where the two words have the same letter (ie. the XOR is zero)
+	uint64 Difference = PackedGuess ^ PackedWord;
+	uint64 ZeroBytes = ~(((Difference & LOW_SEVEN_BITS) + LOW_SEVEN_BITS) | Difference | LOW_SEVEN_BITS);
+
+	FBullCowCount MyBullCowCount;
+	// unused bytes past the end of the word are zero in both so don't count them
+	MyBullCowCount.Bulls = std::bitset<64>(ZeroBytes).count() - (ABSOLUTE_MAX_NUMBER_OF_LETTERS - WordLen);
+	MyBullCowCount.Cows = std::bitset<32>(GuessMask & WordMask).count() - MyBullCowCount.Bulls;
+	return MyBullCowCount;
+}; // ScoreGuess
+
+
+FBullCowCount FBullCowGame::ScoreGuessReference(const FString& Guess, const FString& Word) const
+/*
+private function with the original nested-loop Bulls and Cows count
+kept as the reference that the fast kernel is checked against (see VerifyKernels)
+*/
+{
+	FBullCowCount MyBullCowCount;
+
+	// loop through all letters in the guess
+	int32 WordLen = Word.length();
+	for (int32 GuessChr = 0; GuessChr < WordLen; GuessChr++)
+	{
+		// compare letters against the word
+		for (int32 HiddenWordChr = 0; HiddenWordChr < WordLen; HiddenWordChr++) 
+		{
+			// if there is any match then
+			if (Guess[HiddenWordChr] == Word[GuessChr]) 
+			{
+				if (HiddenWordChr == GuessChr) 
+				{
+					// increment bulls if they're in the same place
+					MyBullCowCount.Bulls++;
+				}
+				else 
+				{
+					// else increment cows if they're in the word but not in the same place
+					MyBullCowCount.Cows++;
+				};
+			}
+			else 
+			{
+				// else no match; no bulls, no cows
+			};
+		}; // next hiddenword
+	}; // next guess
+	return MyBullCowCount;
+}; // ScoreGuessReference
+
+
+void FBullCowGame::PackWord(const FString& Word, uint64& OutPackedWord, uint32& OutLetterMask) const
+/*
+private function to pack a word of up to ABSOLUTE_MAX_NUMBER_OF_LETTERS into one letter per byte
+plus a mask of which letters a-z it contains (flagged NOT_SIMPLE_LETTERS if any repeat or aren't a-z)
+*/
+{
+	OutPackedWord = 0;
+	OutLetterMask = 0;
+	int32 WordLen = Word.length();
+	for (int32 Chr = 0; Chr < WordLen; Chr++)
+	{
+		unsigned char letter = Word[Chr];
+		OutPackedWord |= uint64(letter) << (8 * Chr);
+		uint32 LetterBit = (letter >= 'a' && letter <= 'z') ? (1u << (letter - 'a')) : NOT_SIMPLE_LETTERS;
+		if (OutLetterMask & LetterBit) { LetterBit = NOT_SIMPLE_LETTERS; };
+		OutLetterMask |= LetterBit;
+	};
+	return;
+}; // PackWord
+
+
+FString FBullCowGame::UnpackWord(uint64 PackedWord, int32 WordLen) const
+/*
+private function to turn a packed word back into a string
+*/
+{
+	FString Word(WordLen, ' ');
+	for (int32 Chr = 0; Chr < WordLen; Chr++)
+	{
+		Word[Chr] = static_cast<char>((PackedWord >> (8 * Chr)) & 0xFF);
+	};
+	return Word;
+}; // UnpackWord
+
+
+FCandidateSet FBullCowGame::GetCandidates(int32 HistoryLength)
+/*
+private function to work out which words are consistent with the first HistoryLength guesses
+Each prefix of the history is cached, so a miss only has to filter the previous prefix's survivors by one more guess
+*/
+{
+	int32 NumberOfLetters = GetHiddenWordLength();
+	const FDictionaryView& Dictionary = GetDictionary(NumberOfLetters);
+	FCandidateSet Candidates;
+	if (HistoryLength == 0)
+	{
+		// no guesses yet so every word in the dictionary is possible
+		Candidates.Bits.assign((Dictionary.NumberOfWords + 63) / 64, 0);
+		for (int32 Index = 0; Index < Dictionary.NumberOfWords; Index++) { Candidates.Bits[Index / 64] |= uint64(1) << (Index % 64); };
+		Candidates.Count = Dictionary.NumberOfWords;
+		return Candidates;
+	};
+
+	uint64 Key = GetHistoryKey(HistoryLength);
+	if (HintCache->Find(Key, Candidates)) { return Candidates; };
+
+	// not seen this position before - narrow down the previous position by the latest guess
+	Candidates = GetCandidates(HistoryLength - 1);
+	const FGuessRecord& Record = GuessHistory[HistoryLength - 1];
+	uint64 PackedGuess;
+	uint32 GuessMask;
+	PackWord(Record.Guess, PackedGuess, GuessMask);
+	for (int32 Index = 0; Index < Dictionary.NumberOfWords; Index++)
+	{
+		uint64 Mask = uint64(1) << (Index % 64);
+		if (!(Candidates.Bits[Index / 64] & Mask)) { continue; };
+		FBullCowCount Count = ScoreGuess(PackedGuess, GuessMask, Dictionary.PackedWords[Index], Dictionary.LetterMasks[Index], NumberOfLetters);
+		if (Count.Bulls != Record.BullCowCount.Bulls || Count.Cows != Record.BullCowCount.Cows)
+		{
+			Candidates.Bits[Index / 64] &= ~Mask;
+			Candidates.Count--;
+		};
+	};
+	HintCache->Insert(Key, Candidates);
+	return Candidates;
+}; // GetCandidates
+
+
+uint64 FBullCowGame::GetHistoryKey(int32 HistoryLength) const
+/*
+private function to hash the dictionary in play and the first HistoryLength guesses/responses (64-bit FNV-1a)
+Starting from the dictionary's ContentHash means games sharing a hint cache only match the same list of words
+*/
+{
+	const uint64 FNV_OFFSET_BASIS = 14695981039346656037ULL;
+	const uint64 FNV_PRIME = 1099511628211ULL;
+	uint64 Hash = FNV_OFFSET_BASIS ^ GetDictionary(GetHiddenWordLength()).ContentHash;
+	auto AddByte = [&](unsigned char Byte) { Hash = (Hash ^ Byte) * FNV_PRIME; };
+
+	AddByte(GetHiddenWordLength());
+	for (int32 Index = 0; Index < HistoryLength; Index++)
+	{
+		const FGuessRecord& Record = GuessHistory[Index];
+		for (auto letter : Record.Guess) { AddByte(letter); };
+		AddByte(Record.BullCowCount.Bulls);
+		AddByte(Record.BullCowCount.Cows);
+	};
+	return Hash;
+}; // GetHistoryKey
+
+
+uint64 FBullCowGame::GetContentHash(const FDictionaryView& Dictionary, int32 NumberOfLetters) const
+/*
+private function to hash a dictionary's word length and packed words (in order) to identify it
+*/
+{
+	const uint64 FNV_PRIME = 1099511628211ULL;
+	uint64 Hash = 14695981039346656037ULL ^ NumberOfLetters;
+	for (int32 Index = 0; Index < Dictionary.NumberOfWords; Index++)
+	{
+		Hash = (Hash ^ Dictionary.PackedWords[Index]) * FNV_PRIME;
+		Hash ^= Hash >> 32;
+	};
+	return Hash;
+}; // GetContentHash
+
+
+FKernelCheck FBullCowGame::VerifyKernels() const
+/*
+Differential check of the fast kernels against the original reference implementations
+For every word-length dictionary (each checked on its own thread):
+- every packed word must unpack and re-pack to the same packed word and letter mask
+- IsIsogram must agree with IsIsogramReference for every word
+- the fast Bulls and Cows count must agree with ScoreGuessReference for every (guess, hidden word) pair
+Returns how many checks were made and how many disagreed (should always be zero)
+*/
+{
+	std::deque<FKernelCheck> Results; // deque so references stay valid while threads write to them
+	std::deque<std::thread> Workers;
+	for (auto& Entry : Dictionaries)
+	{
+		Results.push_back(FKernelCheck());
+		FKernelCheck& Result = Results.back();
+		const FDictionaryView& Dictionary = Entry.second;
+		int32 WordLen = Entry.first;
+		Workers.push_back(std::thread([this, &Result, &Dictionary, WordLen]()
+		{
+			int32 DictionarySize = Dictionary.NumberOfWords;
+			std::vector<FString> Words(DictionarySize);
+			for (int32 Index = 0; Index < DictionarySize; Index++) { Words[Index] = UnpackWord(Dictionary.PackedWords[Index], WordLen); };
+			for (int32 Guess = 0; Guess < DictionarySize; Guess++)
+			{
+				const FString& GuessWord = Words[Guess];
+				uint64 PackedWord;
+				uint32 LetterMask;
+				PackWord(GuessWord, PackedWord, LetterMask);
+				Result.Checked += 2;
+				if (PackedWord != Dictionary.PackedWords[Guess] || LetterMask != Dictionary.LetterMasks[Guess]) { Result.Mismatches++; };
+				if (IsIsogram(GuessWord) != IsIsogramReference(GuessWord)) { Result.Mismatches++; };
+				for (int32 Hidden = 0; Hidden < DictionarySize; Hidden++)
+				{
+					FBullCowCount Fast = ScoreGuess(Dictionary.PackedWords[Guess], Dictionary.LetterMasks[Guess], Dictionary.PackedWords[Hidden], Dictionary.LetterMasks[Hidden], WordLen);
+					FBullCowCount Reference = ScoreGuessReference(GuessWord, Words[Hidden]);
+					Result.Checked++;
+					if (Fast.Bulls != Reference.Bulls || Fast.Cows != Reference.Cows) { Result.Mismatches++; };
+				};
+			};
+		}));
+	};
+
+	FKernelCheck Total;
+	for (auto& Worker : Workers) { Worker.join(); };
+	for (auto& Result : Results)
+	{
+		Total.Checked += Result.Checked;
+		Total.Mismatches += Result.Mismatches;
+	};
+	return Total;
+}; // VerifyKernels
+
+
+FKernelCheck FBullCowGame::VerifyKernels(const FString& Guess, const FString& Word) const
+/*
+Differential check of the fast kernels against the reference implementations for any two strings
+(not just dictionary words, so repeated letters, upper case and other bytes are covered too)
+- IsIsogram must agree with IsIsogramReference for both
+- if they are the same length and short enough to pack: both must re-pack unchanged
+  and the fast Bulls and Cows count must agree with ScoreGuessReference
+Used by the fuzz target and verify_kernels
+*/
+{
+	FKernelCheck Result;
+	Result.Checked += 2;
+	if (IsIsogram(Guess) != IsIsogramReference(Guess)) { Result.Mismatches++; };
+	if (IsIsogram(Word) != IsIsogramReference(Word)) { Result.Mismatches++; };
+
+	int32 WordLen = Word.length();
+	if (Guess.length() != Word.length() || WordLen < 1 || WordLen > ABSOLUTE_MAX_NUMBER_OF_LETTERS) { return Result; };
+	uint64 PackedGuess, PackedWord;
+	uint32 GuessMask, WordMask;
+	PackWord(Guess, PackedGuess, GuessMask);
+	PackWord(Word, PackedWord, WordMask);
+	Result.Checked += 3;
+	if (UnpackWord(PackedGuess, WordLen) != Guess) { Result.Mismatches++; };
+	if (UnpackWord(PackedWord, WordLen) != Word) { Result.Mismatches++; };
+	FBullCowCount Fast = ScoreGuess(PackedGuess, GuessMask, PackedWord, WordMask, WordLen);
+	FBullCowCount Reference = ScoreGuessReference(Guess, Word);
+	if (Fast.Bulls != Reference.Bulls || Fast.Cows != Reference.Cows) { Result.Mismatches++; };
+	return Result;
+}; // VerifyKernels
+
+
+FKernelCheck FBullCowGame::VerifyWordList(FString Filename) const
+/*
+Differential check of the loaded dictionaries (private or shared) against the original loader reading Filename
+For every word-length the words, unpacked, must be the same as the original loader's list and in the same order,
+so a word that was dropped, added, reordered or put under the wrong word-length is a mismatch
+Returns how many checks were made and how many disagreed (a file that can't be read counts as one mismatch)
+*/
+{
+	FKernelCheck Result;
+	TMap<int32, std::deque<FString>> ReferenceWordLists;
+	Result.Checked++;
+	if (LoadWordListReference(Filename, ReferenceWordLists) != EFileReadStatus::OK)
+	{
+		Result.Mismatches++;
+		return Result;
+	};
+
+	for (int32 WordLen = 0; WordLen <= ABSOLUTE_MAX_NUMBER_OF_LETTERS; WordLen++)
+	{
+		const FDictionaryView& Dictionary = GetDictionary(WordLen);
+		auto Found = ReferenceWordLists.find(WordLen);
+		int32 ReferenceSize = (Found != ReferenceWordLists.end()) ? Found->second.size() : 0;
+		Result.Checked++;
+		if (Dictionary.NumberOfWords != ReferenceSize) { Result.Mismatches++; };
+		for (int32 Index = 0; Index < Dictionary.NumberOfWords && Index < ReferenceSize; Index++)
+		{
+			Result.Checked++;
+			if (UnpackWord(Dictionary.PackedWords[Index], WordLen) != Found->second[Index]) { Result.Mismatches++; };
+		};
+	};
+	return Result;
+}; // VerifyWordList
+
+
 int32 FBullCowGame::GetRandomNumber(int32 DictionarySize) const
 /*
 private function to return properly random number
@@ -334,6 +890,152 @@ Thankyou: Alex Rivera Rivera https://www.facebook.com/alexarmystrong
 }; // GetRandomNumber
 
 
+void FBullCowGame::BuildAliasTables(FWordList& Dictionary) const
+/*
+private function to build an alias table for each non-uniform EWordSelection
+- Frequency_Weighted: every word, weighted
+- Common_Only: the most common 1/WORD_TIER_FRACTION of words, weighted
+- Hard_Only: the least common 1/WORD_TIER_FRACTION of words, all equally likely
+Tiers are found with nth_element so this stays linear in the size of the dictionary
+*/
+{
+	Dictionary.AliasTables.clear();
+	int32 DictionarySize = Dictionary.PackedWords.size();
+	if (DictionarySize == 0) { return; };
+
+	std::vector<int32> AllWords(DictionarySize);
+	std::iota(AllWords.begin(), AllWords.end(), 0);
+	Dictionary.AliasTables[EWordSelection::Frequency_Weighted] = BuildAliasTable(Dictionary, AllWords, true);
+
+	// partition so the most common words are at the front and the least common at the back
+	int32 TierSize = std::max(1, DictionarySize / WORD_TIER_FRACTION);
+	auto IsMoreCommon = [&Dictionary](int32 A, int32 B) { return Dictionary.Weights[A] > Dictionary.Weights[B]; };
+	std::nth_element(AllWords.begin(), AllWords.begin() + TierSize - 1, AllWords.end(), IsMoreCommon);
+	if (DictionarySize - TierSize > TierSize)
+	{
+		std::nth_element(AllWords.begin() + TierSize, AllWords.end() - TierSize, AllWords.end(), IsMoreCommon);
+	};
+	std::vector<int32> CommonWords(AllWords.begin(), AllWords.begin() + TierSize);
+	std::vector<int32> HardWords(AllWords.end() - TierSize, AllWords.end());
+	Dictionary.AliasTables[EWordSelection::Common_Only] = BuildAliasTable(Dictionary, CommonWords, true);
+	Dictionary.AliasTables[EWordSelection::Hard_Only] = BuildAliasTable(Dictionary, HardWords, false);
+	return;
+}; // BuildAliasTables
+
+
+FAliasTable FBullCowGame::BuildAliasTable(const FWordList& Dictionary, const std::vector<int32>& WordIndex, bool bUseWeights) const
+/*
+private function to build a Walker alias table over the given words (Vose's method, linear time)
+Uses each word's weight, or weights them all equally if bUseWeights is false
+*/
+{
+	FAliasTable Table;
+	int32 NumberOfWords = WordIndex.size();
+	Table.WordIndex = WordIndex;
+	Table.Probability.assign(NumberOfWords, 1.0);
+	Table.Alias.resize(NumberOfWords);
+	std::iota(Table.Alias.begin(), Table.Alias.end(), 0);
+	if (NumberOfWords == 0 || !bUseWeights) { return Table; };
+
+	// scale weights so the average is 1, then split into slots under and over that average
+	double TotalWeight = 0;
+	for (int32 Index : WordIndex) { TotalWeight += Dictionary.Weights[Index]; };
+	std::vector<double> Scaled(NumberOfWords);
+	std::vector<int32> Small, Large;
+	for (int32 Slot = 0; Slot < NumberOfWords; Slot++)
+	{
+		Scaled[Slot] = Dictionary.Weights[WordIndex[Slot]] * NumberOfWords / TotalWeight;
+		(Scaled[Slot] < 1.0 ? Small : Large).push_back(Slot);
+	};
+
+	// top up each under-weight slot with probability from an over-weight one
+	while (!Small.empty() && !Large.empty())
+	{
+		int32 Under = Small.back();
+		Small.pop_back();
+		int32 Over = Large.back();
+		Table.Probability[Under] = Scaled[Under];
+		Table.Alias[Under] = Over;
+		Scaled[Over] = (Scaled[Over] + Scaled[Under]) - 1.0;
+		if (Scaled[Over] < 1.0)
+		{
+			Large.pop_back();
+			Small.push_back(Over);
+		};
+	};
+	// anything left over is (to rounding error) exactly average so keeps probability 1
+	return Table;
+}; // BuildAliasTable
+
+
+int32 FBullCowGame::PickWeightedWord(const FAliasTableView& Table)
+/*
+private function to pick a word (by index into the dictionary) from an alias table in O(1)
+*/
+{
+	std::uniform_int_distribution<int32> PickSlot(0, Table.NumberOfSlots - 1);
+	std::uniform_real_distribution<double> PickKeep(0.0, 1.0);
+	int32 Slot = PickSlot(RandomEngine);
+	if (PickKeep(RandomEngine) >= Table.Probability[Slot]) { Slot = Table.Alias[Slot]; };
+	return Table.WordIndex[Slot];
+}; // PickWeightedWord
+
+
+void FBullCowGame::UpdateDictionaries()
+/*
+private function to point the game's dictionary views at wherever the words now live
+(the shared segment if attached, otherwise MasterWordList) and update the range of word lengths
+*/
+{
+	Dictionaries.clear();
+	for (int32 NumberOfLetters = ABSOLUTE_MIN_NUMBER_OF_LETTERS; NumberOfLetters <= ABSOLUTE_MAX_NUMBER_OF_LETTERS; NumberOfLetters++)
+	{
+		FDictionaryView View;
+		if (SharedDictionary.IsAttached())
+		{
+			View = SharedDictionary.GetDictionary(NumberOfLetters);
+		}
+		else
+		{
+			auto Found = MasterWordList.find(NumberOfLetters);
+			if (Found == MasterWordList.end()) { continue; };
+			const FWordList& WordList = Found->second;
+			View.NumberOfWords = WordList.PackedWords.size();
+			View.PackedWords = WordList.PackedWords.data();
+			View.ContentHash = GetContentHash(View, NumberOfLetters);
+			View.LetterMasks = WordList.LetterMasks.data();
+			View.Weights = WordList.Weights.data();
+			for (auto& Table : WordList.AliasTables)
+			{
+				FAliasTableView& TableView = View.AliasTables[static_cast<int32>(Table.first)];
+				TableView.NumberOfSlots = Table.second.WordIndex.size();
+				TableView.WordIndex = Table.second.WordIndex.data();
+				TableView.Probability = Table.second.Probability.data();
+				TableView.Alias = Table.second.Alias.data();
+			};
+		};
+		if (View.NumberOfWords > 0) { Dictionaries[NumberOfLetters] = View; };
+	};
+	if (!Dictionaries.empty())
+	{
+		MinNumberOfLetters = Dictionaries.begin()->first;
+		MaxNumberOfLetters = Dictionaries.rbegin()->first;
+	};
+	return;
+}; // UpdateDictionaries
+
+
+const FDictionaryView& FBullCowGame::GetDictionary(int32 NumberOfLetters) const
+/*
+private function to get the dictionary for a word length, or an empty one if there are no words that long
+*/
+{
+	static const FDictionaryView EmptyDictionary;
+	auto Found = Dictionaries.find(NumberOfLetters);
+	return (Found != Dictionaries.end()) ? Found->second : EmptyDictionary;
+}; // GetDictionary
+
+
 int32 FBullCowGame::GetDictionarySize()
 /*
 Getter for Dictionary size for current hidden word length that includes check that hidden word has been set
@@ -341,7 +1043,7 @@ Getter for Dictionary size for current hidden word length that includes check th
 {
 	int32 NumberOfLetters = MyHiddenWord.length();
 	if (NumberOfLetters >= MinNumberOfLetters && NumberOfLetters <= MaxNumberOfLetters) {
-		return MasterWordList[NumberOfLetters].WordList.size();
+		return GetDictionary(NumberOfLetters).NumberOfWords;
 	}
 	else 
 	{
@@ -7,21 +7,56 @@ The game logic (no view code or direct user interaction)
 #include <string>
 #include <deque>
 #include <map>
+#include <vector>
+#include <random>
+#include <memory>
+#include "FHintCache.h"
+#include "FSharedDictionary.h"
 
 // to make syntax Unreal-friendly
 #define TMap std::map
 using FString = std::string;
 using int32 = int;
+using uint32 = std::uint32_t;
+
+
+// enum for choosing how SetHiddenWord picks from the dictionary
+enum class EWordSelection
+{
+	Uniform,
+	Frequency_Weighted,
+	Common_Only,
+	Hard_Only
+};
+
+
+/*
+structure to hold a Walker alias table for O(1) weighted picks from (some of) a dictionary
+WordIndex maps each slot back to the word list; each slot keeps its own word with chance Probability
+and otherwise gives the word in slot Alias
+*/
+struct FAliasTable
+{
+	std::vector<int32> WordIndex;
+	std::vector<double> Probability;
+	std::vector<int32> Alias;
+};
 
 
 /*
-structure to hold dictionary of isograms at each word-length
-I use this instead of "TMap<int32, std::deque<FString>> MasterWordList" in the 
-class below purely for legibility
+structure to hold dictionary of isograms at each word-length when loaded by this process
+The game itself reads it through an FDictionaryView so it can equally come from shared memory
+Words are only kept packed (one letter per byte, first letter in lowest byte); UnpackWord gives the string
 */
 struct FWordList
 {
-	std::deque<FString> WordList;
+	// PackedWords, LetterMasks and Weights are at matching indexes, built by LoadWordList
+	// LetterMasks holds one bit per letter a-z, plus NOT_SIMPLE_LETTERS if the reference scorer is needed
+	std::vector<uint64> PackedWords;
+	std::vector<uint32> LetterMasks;
+	// how common each word is (higher is more common), either from the file or from its rank in the file
+	std::vector<double> Weights;
+	TMap<EWordSelection, FAliasTable> AliasTables;
 };
 
 
@@ -47,6 +82,15 @@ enum class EWordLengthStatus
 };
 
 
+// enum for choosing how the hidden word is picked
+// Evil host doesn't commit to a word but keeps as many words possible as it can after each guess
+enum class EHostMode
+{
+	Fair,
+	Evil
+};
+
+
 // enum for returning Isogram File Read status
 enum class EFileReadStatus
 {
@@ -78,6 +122,24 @@ struct FBullCowCount
 };
 
 
+// structure for reporting the differential check of fast kernels against the reference implementations
+// two integers (default zero)
+struct FKernelCheck
+{
+	uint64 Checked = 0;
+	uint64 Mismatches = 0;
+};
+
+
+// structure for remembering each guess and the response given to it
+// used to work out which words are still possible when a hint is requested
+struct FGuessRecord
+{
+	FString Guess;
+	FBullCowCount BullCowCount;
+};
+
+
 // structure for recording results of games
 // three integers (default zero)
 struct FGameStats
@@ -104,36 +166,77 @@ public:
 	int32 GetHiddenWordLength() const;
 	bool GetIsGameWon() const;
 	FGameStats GetGameStats() const;
+	EHostMode GetHostMode() const;
+	void SetHostMode(EHostMode Mode);
+	EWordSelection GetWordSelection() const;
+	void SetWordSelection(EWordSelection Selection);
 	void SetHiddenWord(int32 NumberOfLetters);
 	int32 GetMaxTries();
+	FHintCacheStats GetHintCacheStats() const;
+	void SetHintCacheBudget(uint64 Bytes);
+	void SetHintCache(std::shared_ptr<FHintCache> Cache);
 
 	// public methods
 	void Reset();
 	EFileReadStatus LoadWordList(FString Filename);
+	EFileReadStatus LoadSharedWordList(FString Filename, FString SegmentName);
+	bool IsUsingSharedWordList() const;
 	FWordLength IsValidWordLength(FString Word) const;
 	EGuessStatus CheckGuessValidity(FString) const;
 	FBullCowCount SubmitValidGuess(FString);
 	int32 GetDictionarySize();
 	void UpdateTotalGames();
+	FString GetHint();
+	int32 GetRemainingCandidateCount();
+	FKernelCheck VerifyKernels() const;
+	FKernelCheck VerifyKernels(const FString& Guess, const FString& Word) const;
+	FKernelCheck VerifyWordList(FString Filename) const;
 
 private:
 	// private constants/variables
 	const int32 ABSOLUTE_MIN_NUMBER_OF_LETTERS = 3; // minimum length of Isogram that this program can handle
-	const int32 ABSOLUTE_MAX_NUMBER_OF_LETTERS = 8; // maximum length of Isogram that this program can handle
+	const int32 ABSOLUTE_MAX_NUMBER_OF_LETTERS = 8; // maximum length of Isogram that this program can handle (and that fits in a packed word)
+	const int32 WORD_TIER_FRACTION = 3; // Common_Only picks from the most common third of each dictionary, Hard_Only from the least common third
+	static const uint32 NOT_SIMPLE_LETTERS = 1u << 31; // letter mask flag for words with repeated letters or non a-z characters
 	int32 MinNumberOfLetters = ABSOLUTE_MIN_NUMBER_OF_LETTERS; // may change depending on file being read
 	int32 MaxNumberOfLetters = ABSOLUTE_MAX_NUMBER_OF_LETTERS; // may change depending on file being read
 	int32 MyCurrentTry;
 	FString MyHiddenWord;
 	bool bMyGameWon;
 	FGameStats GameStats;
+	EHostMode HostMode = EHostMode::Fair;
+	EWordSelection WordSelection = EWordSelection::Uniform;
+	std::mt19937 RandomEngine; // for weighted picks; seeded in the constructor
+	std::vector<int32> LiveCandidates; // Evil host only: indexes of words still consistent with every response given
+	std::vector<unsigned char> CandidateResponses; // Evil host only: scratch space for the response each live word would give
+	std::deque<FGuessRecord> GuessHistory; // every guess submitted this game, in order
+	std::shared_ptr<FHintCache> HintCache; // candidate sets for (dictionary, guess history) already worked out; may be shared with other games
 
 	// store list of isograms from 5000 most common English words
 	// see https://www.udemy.com/course/657932/activities/?ids=3614612
 	TMap<int32, FWordList> MasterWordList;
+	FSharedDictionary SharedDictionary; // used instead of MasterWordList once attached
+	TMap<int32, FDictionaryView> Dictionaries; // what the game reads: views of MasterWordList or SharedDictionary
 
 	// private methods
 	int32 GetRandomNumber(int32 DictionarySize) const;
+	EFileReadStatus LoadWordListReference(FString Filename, TMap<int32, std::deque<FString>>& OutWordLists) const;
+	void BuildAliasTables(FWordList& Dictionary) const;
+	FAliasTable BuildAliasTable(const FWordList& Dictionary, const std::vector<int32>& WordIndex, bool bUseWeights) const;
+	int32 PickWeightedWord(const FAliasTableView& Table);
+	void UpdateDictionaries();
+	const FDictionaryView& GetDictionary(int32 NumberOfLetters) const;
 	bool IsIsogram(FString) const;
+	bool IsIsogramReference(FString) const;
 	bool IsLowercase(FString) const;
 	bool IsInteger(FString Word) const;
+	FBullCowCount ScoreGuess(const FString& Guess, const FString& Word) const;
+	FBullCowCount ScoreGuess(uint64 PackedGuess, uint32 GuessMask, uint64 PackedWord, uint32 WordMask, int32 WordLen) const;
+	FBullCowCount ScoreGuessReference(const FString& Guess, const FString& Word) const;
+	void PackWord(const FString& Word, uint64& OutPackedWord, uint32& OutLetterMask) const;
+	FString UnpackWord(uint64 PackedWord, int32 WordLen) const;
+	FCandidateSet GetCandidates(int32 HistoryLength);
+	FBullCowCount SubmitEvilGuess(const FString& ThisGuess);
+	uint64 GetHistoryKey(int32 HistoryLength) const;
+	uint64 GetContentHash(const FDictionaryView& Dictionary, int32 NumberOfLetters) const;
 };
@@ -0,0 +1,172 @@
+/*
+Sharded LRU cache of candidate sets used to answer hint requests
+Each shard gets an equal slice of the memory budget and evicts its own least recently used entries
+*/
+
+#include "FHintCache.h"
+
+FHintCache::FHintCache(uint64 Budget)
+	: MemoryBudget(Budget), Hits(0), Misses(0), Evictions(0) {}; // constructor
+
+
+FHintCacheStats FHintCache::GetStats() const
+/*
+Gathers counters from every shard; entries and bytes are a snapshot so may be slightly stale under concurrent use
+*/
+{
+	FHintCacheStats Stats;
+	Stats.Hits = Hits;
+	Stats.Misses = Misses;
+	Stats.Evictions = Evictions;
+	Stats.MemoryBudget = MemoryBudget;
+	for (const FShard& Shard : Shards)
+	{
+		std::lock_guard<std::mutex> Guard(Shard.Lock);
+		Stats.Entries += Shard.Index.size();
+		Stats.BytesUsed += GetShardBytes(Shard);
+	};
+	return Stats;
+}; // GetStats
+
+
+void FHintCache::SetMemoryBudget(uint64 Budget)
+/*
+Changes the memory budget and immediately evicts anything that no longer fits
+*/
+{
+	MemoryBudget = Budget;
+	uint64 ShardBudget = GetShardBudget();
+	for (FShard& Shard : Shards)
+	{
+		std::lock_guard<std::mutex> Guard(Shard.Lock);
+		EvictToBudget(Shard, ShardBudget);
+	};
+	return;
+}; // SetMemoryBudget
+
+
+bool FHintCache::Find(uint64 Key, FCandidateSet& OutCandidates)
+/*
+Looks up a candidate set by key, copying it to OutCandidates and marking it most recently used
+Returns false (and leaves OutCandidates alone) on a miss
+*/
+{
+	FShard& Shard = GetShard(Key);
+	std::lock_guard<std::mutex> Guard(Shard.Lock);
+	auto Found = Shard.Index.find(Key);
+	if (Found == Shard.Index.end())
+	{
+		Misses++;
+		return false;
+	};
+	// move to front of LRU list without invalidating the stored iterator
+	Shard.Entries.splice(Shard.Entries.begin(), Shard.Entries, Found->second);
+	OutCandidates = Found->second->Candidates;
+	Hits++;
+	return true;
+}; // Find
+
+
+void FHintCache::Insert(uint64 Key, const FCandidateSet& Candidates)
+/*
+Adds (or replaces) a candidate set, evicting least recently used entries in the same shard to stay within budget
+Entries bigger than a whole shard's budget are not cached at all
+*/
+{
+	uint64 Bytes = GetEntryBytes(Candidates);
+	uint64 ShardBudget = GetShardBudget();
+	if (Bytes > ShardBudget) { return; };
+
+	FShard& Shard = GetShard(Key);
+	std::lock_guard<std::mutex> Guard(Shard.Lock);
+	auto Found = Shard.Index.find(Key);
+	if (Found != Shard.Index.end())
+	{
+		// another thread got here first - replace its entry
+		Shard.EntryBytes -= Found->second->Bytes;
+		Shard.Entries.erase(Found->second);
+		Shard.Index.erase(Found);
+	};
+	Shard.Entries.push_front(FEntry{ Key, Bytes, Candidates });
+	Shard.Index[Key] = Shard.Entries.begin();
+	Shard.EntryBytes += Bytes;
+	EvictToBudget(Shard, ShardBudget);
+	return;
+}; // Insert
+
+
+void FHintCache::Clear()
+/*
+Empties every shard, for callers that want to give the memory back or start afresh; counters are kept
+(loading a new word list doesn't need it, as entries for the old list are never matched and just age out)
+*/
+{
+	for (FShard& Shard : Shards)
+	{
+		std::lock_guard<std::mutex> Guard(Shard.Lock);
+		Shard.Entries.clear();
+		Shard.Index.clear();
+		Shard.EntryBytes = 0;
+	};
+	return;
+}; // Clear
+
+
+FHintCache::FShard& FHintCache::GetShard(uint64 Key)
+/*
+private function to pick the shard for a key
+keys are already well-mixed hashes so the low bits are good enough
+*/
+{
+	return Shards[Key & (NUMBER_OF_SHARDS - 1)];
+}; // GetShard
+
+
+uint64 FHintCache::GetShardBudget() const
+{
+	return MemoryBudget / NUMBER_OF_SHARDS;
+}; // GetShardBudget
+
+
+uint64 FHintCache::GetEntryBytes(const FCandidateSet& Candidates)
+/*
+private function to estimate the heap memory one entry takes: its list node (entry plus prev/next links),
+its index node (key, iterator and next link) and its bitset, each rounded up the way a typical malloc
+does it (a word of header, 16-byte granularity)
+*/
+{
+	auto Allocation = [](uint64 Requested) { return (Requested + sizeof(void*) + 15) & ~uint64(15); };
+	uint64 ListNode = sizeof(FEntry) + 2 * sizeof(void*);
+	uint64 IndexNode = sizeof(std::pair<const uint64, std::list<FEntry>::iterator>) + sizeof(void*);
+	uint64 Bitset = Candidates.Bits.size() * sizeof(uint64);
+	return Allocation(ListNode) + Allocation(IndexNode) + ((Bitset > 0) ? Allocation(Bitset) : 0);
+}; // GetEntryBytes
+
+
+uint64 FHintCache::GetShardBytes(const FShard& Shard)
+/*
+private function to estimate the heap memory a shard takes: its entries plus the index's bucket array
+(which grows with the number of entries and is not given back when they are evicted)
+caller must hold the shard lock
+*/
+{
+	return Shard.EntryBytes + Shard.Index.bucket_count() * sizeof(void*);
+}; // GetShardBytes
+
+
+void FHintCache::EvictToBudget(FShard& Shard, uint64 ShardBudget)
+/*
+private function to drop least recently used entries until the shard fits its budget
+caller must hold the shard lock
+*/
+{
+	while (GetShardBytes(Shard) > ShardBudget && !Shard.Entries.empty())
+	{
+		FEntry& Oldest = Shard.Entries.back();
+		Shard.EntryBytes -= Oldest.Bytes;
+		Shard.Index.erase(Oldest.Key);
+		Shard.Entries.pop_back();
+		Evictions++;
+	};
+	return;
+}; // EvictToBudget
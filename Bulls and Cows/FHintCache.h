@@ -0,0 +1,96 @@
+/*
+Bounded cache of candidate sets that can be shared (see FBullCowGame::SetHintCache) by every game in a process
+
+Keyed by a 64-bit hash of (dictionary contents, guess/response history) so that players who
+reach the same position with the same dictionary don't have to re-filter it again.
+Split into shards, each with its own lock and LRU list, so concurrent lookups rarely contend
+
+*/
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// to make syntax Unreal-friendly
+using int32 = int;
+using uint64 = std::uint64_t;
+
+
+/*
+structure to hold the words of one dictionary (word-length) still consistent with every guess so far
+one bit per word (by index into the WordList) plus a running count of bits set
+*/
+struct FCandidateSet
+{
+	std::vector<uint64> Bits;
+	int32 Count = 0;
+};
+
+
+// structure for reporting how well the hint cache is doing
+// all counters default zero
+struct FHintCacheStats
+{
+	uint64 Hits = 0;
+	uint64 Misses = 0;
+	uint64 Evictions = 0;
+	uint64 Entries = 0;
+	uint64 BytesUsed = 0; // estimated heap use of the entries, their index nodes and the index buckets
+	uint64 MemoryBudget = 0;
+};
+
+
+class FHintCache
+{
+public:
+	static const uint64 DEFAULT_MEMORY_BUDGET = 4 * 1024 * 1024; // bytes, across all shards
+
+	FHintCache(uint64 Budget = DEFAULT_MEMORY_BUDGET); // constructor
+	FHintCache(const FHintCache&) = delete;
+	FHintCache& operator=(const FHintCache&) = delete;
+
+	// public getters/setters
+	FHintCacheStats GetStats() const;
+	void SetMemoryBudget(uint64 Budget);
+
+	// public methods
+	bool Find(uint64 Key, FCandidateSet& OutCandidates);
+	void Insert(uint64 Key, const FCandidateSet& Candidates);
+	void Clear();
+
+private:
+	static const int32 NUMBER_OF_SHARDS = 16; // power of two so the shard is picked from the low bits of the key
+
+	struct FEntry
+	{
+		uint64 Key;
+		uint64 Bytes;
+		FCandidateSet Candidates;
+	};
+
+	// most recently used entry is at the front of Entries, least recently used at the back
+	struct FShard
+	{
+		mutable std::mutex Lock;
+		std::list<FEntry> Entries;
+		std::unordered_map<uint64, std::list<FEntry>::iterator> Index;
+		uint64 EntryBytes = 0; // sum of Bytes over Entries (the index's bucket array is extra, see GetShardBytes)
+	};
+
+	FShard Shards[NUMBER_OF_SHARDS];
+	std::atomic<uint64> MemoryBudget;
+	std::atomic<uint64> Hits;
+	std::atomic<uint64> Misses;
+	std::atomic<uint64> Evictions;
+
+	// private methods
+	FShard& GetShard(uint64 Key);
+	uint64 GetShardBudget() const;
+	static uint64 GetEntryBytes(const FCandidateSet& Candidates);
+	static uint64 GetShardBytes(const FShard& Shard);
+	void EvictToBudget(FShard& Shard, uint64 ShardBudget);
+};
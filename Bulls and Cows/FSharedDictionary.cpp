@@ -0,0 +1,364 @@
+/*
+POSIX shared memory segment holding the packed dictionary, letter masks, weights and alias tables
+Layout: FSharedHeader at offset 0, then each array 8-byte aligned; the header stores every array's offset
+
+Without POSIX shared memory (eg. building with Visual Studio on Windows) Create and Attach always fail
+and GetFileIdentity returns 0, so FBullCowGame::LoadSharedWordList keeps its own private copy instead
+*/
+
+#include "FSharedDictionary.h"
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define BULLCOW_SHARED_MEMORY 1
+#include <chrono>
+#include <thread>
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define BULLCOW_SHARED_MEMORY 0
+#endif
+
+FSharedDictionary::FSharedDictionary() : Base(nullptr), SegmentSize(0) {}; // constructor
+FSharedDictionary::~FSharedDictionary() { Detach(); }; // destructor
+
+// getters
+bool FSharedDictionary::IsAttached() const { return Base != nullptr; };
+uint64 FSharedDictionary::GetSegmentSize() const { return SegmentSize; };
+
+
+FDictionaryView FSharedDictionary::GetDictionary(int32 NumberOfLetters) const
+/*
+Returns a view of the dictionary for one word length, pointing straight into the segment
+Returns an empty view if not attached or there are no words of that length
+*/
+{
+	FDictionaryView View;
+	if (!IsAttached() || NumberOfLetters < 0 || NumberOfLetters > MAX_NUMBER_OF_LETTERS) { return View; };
+	const FSharedWordList& WordList = GetHeader()->WordLists[NumberOfLetters];
+	View.NumberOfWords = WordList.NumberOfWords;
+	View.ContentHash = WordList.ContentHash;
+	View.PackedWords = GetArray<uint64>(WordList.PackedWordsOffset);
+	View.LetterMasks = GetArray<uint32>(WordList.LetterMasksOffset);
+	View.Weights = GetArray<double>(WordList.WeightsOffset);
+	for (int32 Table = 0; Table < FDictionaryView::NUMBER_OF_ALIAS_TABLES; Table++)
+	{
+		const FSharedAliasTable& AliasTable = WordList.AliasTables[Table];
+		View.AliasTables[Table].NumberOfSlots = AliasTable.NumberOfSlots;
+		View.AliasTables[Table].WordIndex = GetArray<int32>(AliasTable.WordIndexOffset);
+		View.AliasTables[Table].Probability = GetArray<double>(AliasTable.ProbabilityOffset);
+		View.AliasTables[Table].Alias = GetArray<int32>(AliasTable.AliasOffset);
+	};
+	return View;
+}; // GetDictionary
+
+
+// methods
+#if BULLCOW_SHARED_MEMORY
+
+bool FSharedDictionary::Create(FString SegmentName, const TMap<int32, FDictionaryView>& Dictionaries, uint64 SourceIdentity)
+/*
+Creates a new segment called SegmentName (eg. "/bullcow-isograms") and copies the dictionaries into it
+SourceIdentity (see GetFileIdentity) is stored so later processes can tell if it was built from the file they want
+The segment is marked Ready once filled so attaching processes never see it half-built, then made read-only
+Returns false if the segment already exists (so the caller should Attach instead) or anything fails
+*/
+{
+	Detach();
+
+	// work out where everything goes, keeping each array 8-byte aligned
+	uint64 Offset = sizeof(FSharedHeader);
+	auto Reserve = [&Offset](uint64 Bytes) { uint64 Start = Offset; Offset += (Bytes + 7) & ~uint64(7); return Start; };
+	FSharedWordList Layout[MAX_NUMBER_OF_LETTERS + 1] = {};
+	for (auto& Entry : Dictionaries)
+	{
+		if (Entry.first < 0 || Entry.first > MAX_NUMBER_OF_LETTERS) { continue; };
+		const FDictionaryView& View = Entry.second;
+		FSharedWordList& WordList = Layout[Entry.first];
+		WordList.NumberOfWords = View.NumberOfWords;
+		WordList.ContentHash = View.ContentHash;
+		WordList.PackedWordsOffset = Reserve(View.NumberOfWords * sizeof(uint64));
+		WordList.LetterMasksOffset = Reserve(View.NumberOfWords * sizeof(uint32));
+		WordList.WeightsOffset = Reserve(View.NumberOfWords * sizeof(double));
+		for (int32 Table = 0; Table < FDictionaryView::NUMBER_OF_ALIAS_TABLES; Table++)
+		{
+			int32 NumberOfSlots = View.AliasTables[Table].NumberOfSlots;
+			WordList.AliasTables[Table].NumberOfSlots = NumberOfSlots;
+			WordList.AliasTables[Table].WordIndexOffset = Reserve(NumberOfSlots * sizeof(int32));
+			WordList.AliasTables[Table].ProbabilityOffset = Reserve(NumberOfSlots * sizeof(double));
+			WordList.AliasTables[Table].AliasOffset = Reserve(NumberOfSlots * sizeof(int32));
+		};
+	};
+	uint64 Size = Offset;
+
+	// O_EXCL so exactly one process gets to build it
+	int Descriptor = shm_open(SegmentName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+	if (Descriptor < 0) { return false; };
+	if (ftruncate(Descriptor, Size) != 0)
+	{
+		close(Descriptor);
+		shm_unlink(SegmentName.c_str());
+		return false;
+	};
+	void* Mapping = mmap(nullptr, Size, PROT_READ | PROT_WRITE, MAP_SHARED, Descriptor, 0);
+	close(Descriptor);
+	if (Mapping == MAP_FAILED)
+	{
+		shm_unlink(SegmentName.c_str());
+		return false;
+	};
+
+	// say who is building it, fill in the arrays then the header, and only then mark it Ready
+	char* Writable = static_cast<char*>(Mapping);
+	FSharedHeader* Header = reinterpret_cast<FSharedHeader*>(Writable);
+	// atomic as attachers poll it while we fill in the rest
+	Header->BuilderProcess.store(getpid(), std::memory_order_release);
+	for (auto& Entry : Dictionaries)
+	{
+		if (Entry.first < 0 || Entry.first > MAX_NUMBER_OF_LETTERS) { continue; };
+		const FDictionaryView& View = Entry.second;
+		const FSharedWordList& WordList = Layout[Entry.first];
+		if (View.NumberOfWords > 0)
+		{
+			memcpy(Writable + WordList.PackedWordsOffset, View.PackedWords, View.NumberOfWords * sizeof(uint64));
+			memcpy(Writable + WordList.LetterMasksOffset, View.LetterMasks, View.NumberOfWords * sizeof(uint32));
+			memcpy(Writable + WordList.WeightsOffset, View.Weights, View.NumberOfWords * sizeof(double));
+		};
+		for (int32 Table = 0; Table < FDictionaryView::NUMBER_OF_ALIAS_TABLES; Table++)
+		{
+			const FAliasTableView& AliasTable = View.AliasTables[Table];
+			if (AliasTable.NumberOfSlots == 0) { continue; };
+			memcpy(Writable + WordList.AliasTables[Table].WordIndexOffset, AliasTable.WordIndex, AliasTable.NumberOfSlots * sizeof(int32));
+			memcpy(Writable + WordList.AliasTables[Table].ProbabilityOffset, AliasTable.Probability, AliasTable.NumberOfSlots * sizeof(double));
+			memcpy(Writable + WordList.AliasTables[Table].AliasOffset, AliasTable.Alias, AliasTable.NumberOfSlots * sizeof(int32));
+		};
+	};
+	memcpy(Header->WordLists, Layout, sizeof(Layout));
+	Header->Version = SEGMENT_VERSION;
+	Header->Magic = SEGMENT_MAGIC;
+	Header->SegmentSize = Size;
+	Header->SourceIdentity = SourceIdentity;
+	Header->State.store(Ready, std::memory_order_release);
+
+	// nothing writes to it again
+	mprotect(Mapping, Size, PROT_READ);
+	Base = Writable;
+	SegmentSize = Size;
+	return true;
+}; // Create
+
+
+bool FSharedDictionary::Attach(FString SegmentName, uint64 SourceIdentity)
+/*
+Maps an existing segment read-only, waiting (up to ATTACH_TIMEOUT_MS) if another process is still building it
+No parsing or copying (the stored indexes are only read through once to check them), so attaching is quick
+Returns false if there is no such segment or it can't be used; a segment that can't be used (built from a
+different SourceIdentity, builder died or timed out, or bad layout) is removed so the caller can Create a new one
+*/
+{
+	Detach();
+	int Descriptor = shm_open(SegmentName.c_str(), O_RDONLY, 0);
+	if (Descriptor < 0) { return false; };
+
+	// copy the constant so the duration's constructor doesn't need it to have an address
+	const int32 TimeoutMs = ATTACH_TIMEOUT_MS;
+	auto Deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(TimeoutMs);
+	auto WaitABit = [Deadline]()
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		return std::chrono::steady_clock::now() < Deadline;
+	};
+
+	// the creator may not have sized the segment yet...
+	struct stat Status;
+	do
+	{
+		if (fstat(Descriptor, &Status) != 0)
+		{
+			close(Descriptor);
+			return false;
+		};
+	} while (Status.st_size < (off_t)sizeof(FSharedHeader) && WaitABit());
+	if (Status.st_size < (off_t)sizeof(FSharedHeader))
+	{
+		// never sized, so whoever created it is long gone
+		RemoveIfSame(SegmentName, Descriptor);
+		close(Descriptor);
+		return false;
+	};
+	void* Mapping = mmap(nullptr, Status.st_size, PROT_READ, MAP_SHARED, Descriptor, 0);
+	if (Mapping == MAP_FAILED)
+	{
+		close(Descriptor);
+		return false;
+	};
+
+	// ...or finished filling it in (no point waiting if the builder has died)
+	const FSharedHeader* Header = static_cast<const FSharedHeader*>(Mapping);
+	auto IsBuilderDead = [Header]()
+	{
+		int32 Builder = Header->BuilderProcess.load(std::memory_order_acquire);
+		return Builder != 0 && kill(Builder, 0) != 0 && errno == ESRCH;
+	};
+	while (Header->State.load(std::memory_order_acquire) == Building && !IsBuilderDead() && WaitABit()) {};
+	if (Header->State.load(std::memory_order_acquire) != Ready || Header->Magic != SEGMENT_MAGIC
+		|| Header->Version != SEGMENT_VERSION || Header->SegmentSize > (uint64)Status.st_size
+		|| Header->SourceIdentity != SourceIdentity || !IsLayoutValid(Header, Status.st_size))
+	{
+		munmap(Mapping, Status.st_size);
+		RemoveIfSame(SegmentName, Descriptor);
+		close(Descriptor);
+		return false;
+	};
+	close(Descriptor);
+	Base = static_cast<const char*>(Mapping);
+	SegmentSize = Status.st_size;
+	return true;
+}; // Attach
+
+
+void FSharedDictionary::Detach()
+/*
+Unmaps the segment from this process (other processes are unaffected)
+*/
+{
+	if (Base != nullptr) { munmap(const_cast<char*>(Base), SegmentSize); };
+	Base = nullptr;
+	SegmentSize = 0;
+	return;
+}; // Detach
+
+
+uint64 FSharedDictionary::GetFileIdentity(FString Filename)
+/*
+Identifies a version of a file by its size and modification time, without reading it
+Returns 0 if the file can't be found
+*/
+{
+	struct stat Status;
+	if (stat(Filename.c_str(), &Status) != 0) { return 0; };
+#if defined(__APPLE__)
+	const struct timespec& Modified = Status.st_mtimespec;
+#else
+	const struct timespec& Modified = Status.st_mtim;
+#endif
+	uint64 ModifiedNs = uint64(Modified.tv_sec) * 1000000000ULL + Modified.tv_nsec;
+	uint64 Identity = (uint64(Status.st_size) * 1099511628211ULL) ^ ModifiedNs ^ (uint64(Status.st_ino) << 32);
+	return (Identity == 0) ? 1 : Identity;
+}; // GetFileIdentity
+
+
+bool FSharedDictionary::Remove(FString SegmentName)
+/*
+Removes the segment name so the next process builds a fresh one (eg. after the isograms file changes)
+Processes already attached keep their mapping until they detach
+*/
+{
+	return shm_unlink(SegmentName.c_str()) == 0;
+}; // Remove
+
+
+void FSharedDictionary::RemoveIfSame(FString SegmentName, int Descriptor)
+/*
+private function to remove an unusable segment, but only if the name still refers to the one we opened
+(another process may already have removed it and built a replacement)
+*/
+{
+	struct stat Ours, Current;
+	int CurrentDescriptor = shm_open(SegmentName.c_str(), O_RDONLY, 0);
+	if (CurrentDescriptor < 0) { return; };
+	if (fstat(Descriptor, &Ours) == 0 && fstat(CurrentDescriptor, &Current) == 0
+		&& Ours.st_dev == Current.st_dev && Ours.st_ino == Current.st_ino)
+	{
+		shm_unlink(SegmentName.c_str());
+	};
+	close(CurrentDescriptor);
+	return;
+}; // RemoveIfSame
+
+#else
+
+// no shared memory on this platform: nothing can be created or attached, so callers use a private copy
+bool FSharedDictionary::Create(FString SegmentName, const TMap<int32, FDictionaryView>& Dictionaries, uint64 SourceIdentity) { return false; };
+bool FSharedDictionary::Attach(FString SegmentName, uint64 SourceIdentity) { return false; };
+void FSharedDictionary::Detach() { Base = nullptr; SegmentSize = 0; };
+uint64 FSharedDictionary::GetFileIdentity(FString Filename) { return 0; };
+bool FSharedDictionary::Remove(FString SegmentName) { return false; };
+void FSharedDictionary::RemoveIfSame(FString SegmentName, int Descriptor) {};
+
+#endif // BULLCOW_SHARED_MEMORY
+
+
+const FSharedDictionary::FSharedHeader* FSharedDictionary::GetHeader() const
+{
+	return reinterpret_cast<const FSharedHeader*>(Base);
+}; // GetHeader
+
+
+bool FSharedDictionary::IsLayoutValid(const FSharedHeader* Header, uint64 Size)
+/*
+private function to check, before any pointers into the segment are handed out, that
+- every array the header points at lies inside the segment
+- every alias table but the first (EWordSelection::Uniform, left empty) has slots if there are words to pick
+- every word index and alias stored in an alias table is in range, as they are used to index arrays directly
+*/
+{
+	const char* Base = reinterpret_cast<const char*>(Header);
+	for (const FSharedWordList& WordList : Header->WordLists)
+	{
+		if (!IsArrayInSegment(WordList.PackedWordsOffset, WordList.NumberOfWords, sizeof(uint64), Size)
+			|| !IsArrayInSegment(WordList.LetterMasksOffset, WordList.NumberOfWords, sizeof(uint32), Size)
+			|| !IsArrayInSegment(WordList.WeightsOffset, WordList.NumberOfWords, sizeof(double), Size))
+		{
+			return false;
+		};
+		for (int32 Table = 0; Table < FDictionaryView::NUMBER_OF_ALIAS_TABLES; Table++)
+		{
+			const FSharedAliasTable& AliasTable = WordList.AliasTables[Table];
+			if (!IsArrayInSegment(AliasTable.WordIndexOffset, AliasTable.NumberOfSlots, sizeof(int32), Size)
+				|| !IsArrayInSegment(AliasTable.ProbabilityOffset, AliasTable.NumberOfSlots, sizeof(double), Size)
+				|| !IsArrayInSegment(AliasTable.AliasOffset, AliasTable.NumberOfSlots, sizeof(int32), Size))
+			{
+				return false;
+			};
+			if (Table > 0 && WordList.NumberOfWords > 0 && AliasTable.NumberOfSlots == 0) { return false; };
+			const int32* WordIndex = reinterpret_cast<const int32*>(Base + AliasTable.WordIndexOffset);
+			const int32* Alias = reinterpret_cast<const int32*>(Base + AliasTable.AliasOffset);
+			for (int32 Slot = 0; Slot < AliasTable.NumberOfSlots; Slot++)
+			{
+				if (WordIndex[Slot] < 0 || WordIndex[Slot] >= WordList.NumberOfWords
+					|| Alias[Slot] < 0 || Alias[Slot] >= AliasTable.NumberOfSlots)
+				{
+					return false;
+				};
+			};
+		};
+	};
+	return true;
+}; // IsLayoutValid
+
+
+bool FSharedDictionary::IsArrayInSegment(uint64 Offset, int32 Count, uint64 ElementSize, uint64 Size)
+/*
+private function to check an array of Count elements at Offset is after the header, aligned and ends inside the segment
+(empty arrays, eg. for word lengths not in the file, aren't looked at so can be anywhere)
+*/
+{
+	if (Count == 0) { return true; };
+	if (Count < 0 || Offset < sizeof(FSharedHeader) || Offset > Size || Offset % 8 != 0) { return false; };
+	return uint64(Count) <= (Size - Offset) / ElementSize;
+}; // IsArrayInSegment
+
+
+template <typename T>
+const T* FSharedDictionary::GetArray(uint64 Offset) const
+/*
+private function to turn an offset from the start of the segment into a pointer in this process
+*/
+{
+	return reinterpret_cast<const T*>(Base + Offset);
+}; // GetArray
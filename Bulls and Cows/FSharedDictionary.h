@@ -0,0 +1,129 @@
+/*
+Read-only dictionary in POSIX shared memory so many game processes on a host can share one copy
+
+The first process to ask for a segment name builds it from its own dictionary; later processes just attach.
+Everything in the segment is found by offset from its start, so it works wherever each process maps it
+A segment built from a different version of the source file, or whose builder died, is removed so it can be rebuilt
+
+*/
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+
+// to make syntax Unreal-friendly
+#define TMap std::map
+using FString = std::string;
+using int32 = int;
+using uint32 = std::uint32_t;
+using uint64 = std::uint64_t;
+
+
+/*
+structure for reading an alias table (see FAliasTable) wherever it is stored
+WordIndex, Probability and Alias each have NumberOfSlots entries
+*/
+struct FAliasTableView
+{
+	int32 NumberOfSlots = 0;
+	const int32* WordIndex = nullptr;
+	const double* Probability = nullptr;
+	const int32* Alias = nullptr;
+};
+
+
+/*
+structure for reading the dictionary of one word-length wherever it is stored
+(this process's own FWordList or a shared segment)
+PackedWords, LetterMasks and Weights each have NumberOfWords entries
+AliasTables is indexed by EWordSelection (the Uniform entry is left empty)
+*/
+struct FDictionaryView
+{
+	static const int32 NUMBER_OF_ALIAS_TABLES = 4;
+
+	int32 NumberOfWords = 0;
+	uint64 ContentHash = 0; // identifies this exact list of words, eg. for hint cache keys
+	const uint64* PackedWords = nullptr;
+	const uint32* LetterMasks = nullptr;
+	const double* Weights = nullptr;
+	FAliasTableView AliasTables[NUMBER_OF_ALIAS_TABLES];
+};
+
+
+class FSharedDictionary
+{
+public:
+	FSharedDictionary(); // constructor
+	~FSharedDictionary(); // unmaps but leaves the segment for other processes
+	FSharedDictionary(const FSharedDictionary&) = delete;
+	FSharedDictionary& operator=(const FSharedDictionary&) = delete;
+
+	// public getters
+	bool IsAttached() const;
+	uint64 GetSegmentSize() const;
+	FDictionaryView GetDictionary(int32 NumberOfLetters) const;
+
+	// public methods
+	bool Create(FString SegmentName, const TMap<int32, FDictionaryView>& Dictionaries, uint64 SourceIdentity);
+	bool Attach(FString SegmentName, uint64 SourceIdentity);
+	void Detach();
+	static bool Remove(FString SegmentName);
+	static uint64 GetFileIdentity(FString Filename);
+
+private:
+	static const uint64 SEGMENT_MAGIC = 0x5342434F57444943ULL; // "SBCOWDIC"
+	static const uint32 SEGMENT_VERSION = 2;
+	static const int32 MAX_NUMBER_OF_LETTERS = 8; // matches the longest word FBullCowGame can pack
+	static const int32 ATTACH_TIMEOUT_MS = 5000; // how long to wait for another process to finish building the segment
+
+	// segment states; a freshly sized segment is all zeroes so starts out Building
+	enum ESegmentState : uint32
+	{
+		Building = 0,
+		Ready = 1
+	};
+
+	// offset-based versions of the views above, stored in the segment
+	struct FSharedAliasTable
+	{
+		int32 NumberOfSlots;
+		uint64 WordIndexOffset;
+		uint64 ProbabilityOffset;
+		uint64 AliasOffset;
+	};
+
+	struct FSharedWordList
+	{
+		int32 NumberOfWords;
+		uint64 ContentHash;
+		uint64 PackedWordsOffset;
+		uint64 LetterMasksOffset;
+		uint64 WeightsOffset;
+		FSharedAliasTable AliasTables[FDictionaryView::NUMBER_OF_ALIAS_TABLES];
+	};
+
+	// at offset 0 of the segment, followed by all the arrays
+	struct FSharedHeader
+	{
+		std::atomic<uint32> State;
+		uint32 Version;
+		std::atomic<int32> BuilderProcess; // process id of the creator, so attachers can tell if it died part way through
+		uint64 Magic;
+		uint64 SegmentSize;
+		uint64 SourceIdentity; // GetFileIdentity of the isograms file it was built from
+		FSharedWordList WordLists[MAX_NUMBER_OF_LETTERS + 1]; // indexed by word length
+	};
+
+	const char* Base;
+	uint64 SegmentSize;
+
+	// private methods
+	const FSharedHeader* GetHeader() const;
+	template <typename T> const T* GetArray(uint64 Offset) const;
+	static bool IsLayoutValid(const FSharedHeader* Header, uint64 Size);
+	static bool IsArrayInSegment(uint64 Offset, int32 Count, uint64 ElementSize, uint64 Size);
+	static void RemoveIfSame(FString SegmentName, int Descriptor);
+};
@@ -0,0 +1,90 @@
+/*
+Headless benchmark of the FBullCowGame core (no user interaction)
+Used as both the PGO training run and the timed workload by perf_compare.sh
+
+Before timing, the fast kernels are checked once against the reference implementations
+
+Workload (fixed, so runs are comparable):
+- load the isograms file
+- for every word in the isograms file, play a game against the Evil host opening with that word
+  and then following the hints until won
+
+*/
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "FBullCowGame.h"
+
+// to make syntax Unreal-friendly
+using int32 = int;
+
+
+// The entry-point for the benchmark
+// usage: benchmark <isograms file> [repeats]
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		std::cout << "usage: " << argv[0] << " <isograms file> [repeats]\n";
+		return 2;
+	};
+	FString IsogramFile = argv[1];
+	int32 Repeats = (argc > 2) ? std::stoi(argv[2]) : 1;
+
+	// a fast kernel that disagrees with the reference makes the timings meaningless, so check once up front
+	{
+		FBullCowGame CheckGame;
+		if (CheckGame.LoadWordList(IsogramFile) != EFileReadStatus::OK)
+		{
+			std::cout << "ERROR: Unable to load Isogram file: " << IsogramFile << std::endl;
+			return 1;
+		};
+		FKernelCheck KernelCheck = CheckGame.VerifyKernels();
+		if (KernelCheck.Mismatches > 0)
+		{
+			std::cout << "ERROR: " << KernelCheck.Mismatches << " kernel mismatches out of " << KernelCheck.Checked << std::endl;
+			return 1;
+		};
+	};
+
+	auto StartTime = std::chrono::steady_clock::now();
+	uint64 Guesses = 0;
+	uint64 Games = 0;
+	for (int32 Repeat = 0; Repeat < Repeats; Repeat++)
+	{
+		FBullCowGame BCGame;
+		if (BCGame.LoadWordList(IsogramFile) != EFileReadStatus::OK)
+		{
+			std::cout << "ERROR: Unable to load Isogram file: " << IsogramFile << std::endl;
+			return 1;
+		};
+
+		BCGame.SetHostMode(EHostMode::Evil);
+		std::ifstream Openers(IsogramFile);
+		FString Opener;
+		while (getline(Openers, Opener))
+		{
+			FWordLength WordLength = BCGame.IsValidWordLength(std::to_string(Opener.length()));
+			if (WordLength.Status != EWordLengthStatus::OK) { continue; };
+			BCGame.SetHiddenWord(WordLength.Length);
+			if (BCGame.CheckGuessValidity(Opener) != EGuessStatus::OK) { continue; };
+
+			FString Guess = Opener;
+			while (!BCGame.GetIsGameWon())
+			{
+				BCGame.SubmitValidGuess(Guess);
+				Guesses++;
+				Guess = BCGame.GetHint();
+			};
+			BCGame.UpdateTotalGames();
+			Games++;
+		};
+	};
+	double ElapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - StartTime).count();
+
+	// one line, easy for scripts to pick apart
+	std::cout << "games=" << Games << " guesses=" << Guesses << " elapsed_ms=" << ElapsedMs << std::endl;
+	return 0;
+}; // main
@@ -0,0 +1,33 @@
+/*
+libFuzzer target comparing the fast kernels against the reference implementations on arbitrary bytes
+Build and run with eg. (leave out -lrt on macOS)
+  clang++ -std=c++11 -g -O1 -fsanitize=fuzzer,address fuzz_kernels.cpp FBullCowGame.cpp FHintCache.cpp FSharedDictionary.cpp -lrt -o fuzz_kernels
+  ./fuzz_kernels
+
+Input: the bytes are split in half, one half is the guess and the other the word it's scored against
+
+*/
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include "FBullCowGame.h"
+
+// no word list needed; only the kernels are used
+static FBullCowGame BCGame;
+
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* Data, std::size_t Size)
+{
+	std::size_t Half = Size / 2;
+	FString Guess(reinterpret_cast<const char*>(Data), Half);
+	FString Word(reinterpret_cast<const char*>(Data) + Half, Half);
+	FKernelCheck KernelCheck = BCGame.VerifyKernels(Guess, Word);
+	if (KernelCheck.Mismatches > 0)
+	{
+		// crash so libFuzzer saves the input
+		std::cerr << "Kernel mismatch for guess \"" << Guess << "\" and word \"" << Word << "\"\n";
+		abort();
+	};
+	return 0;
+}; // LLVMFuzzerTestOneInput
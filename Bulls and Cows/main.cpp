@@ -13,7 +13,11 @@ This acts as the View in MVC.
 using FText = std::string;
 using int32 = int;
 
+// can be overridden by giving the path to an isograms file on the command line
 FString ISOGRAM_FILE = "E:\\Documents\\Unreal Projects\\Udemy-UnrealCourse\\Section_02\\Bulls and Cows\\Debug\\isograms.txt";
+// if a shared memory segment name (eg. /bullcow-isograms) is given on the command line after the file,
+// every copy of the game run with that name shares one copy of the word list
+FString SHARED_SEGMENT_NAME = "";
 
 
 // enum for returning Play Again result
@@ -30,6 +34,8 @@ enum class EGameReplayStatus
 void PrintIntro();
 void PlayTheGame();
 bool LoadWordList();
+void AskForHostMode();
+void AskForWordSelection();
 int32 GetNumberOfLetters();
 FText GetValidGuess();
 EGameReplayStatus AskToPlayAgain();
@@ -41,13 +47,17 @@ FBullCowGame BCGame;
 
 
 // The entry-point for game
-int main()
+int main(int argc, char* argv[])
 {
+	if (argc > 1) { ISOGRAM_FILE = argv[1]; };
+	if (argc > 2) { SHARED_SEGMENT_NAME = argv[2]; };
 	int32 NumberOfGames = 0;
 	int32 NumberOfLetters;
 	EGameReplayStatus PlayAgainStatus;
 	PrintIntro();
 	if (LoadWordList()) {
+		AskForHostMode();
+		AskForWordSelection();
 		do 
 		{ // loop from here if we want to replay with different word length
 			NumberOfLetters = GetNumberOfLetters();
@@ -109,7 +119,7 @@ Tries to load the ISOGRAM file from the folder specified and reports on any erro
 */
 {
 	std::cout << "\nLoading list of isograms...";
-	EFileReadStatus FileStatus = BCGame.LoadWordList(ISOGRAM_FILE);
+	EFileReadStatus FileStatus = SHARED_SEGMENT_NAME.empty() ? BCGame.LoadWordList(ISOGRAM_FILE) : BCGame.LoadSharedWordList(ISOGRAM_FILE, SHARED_SEGMENT_NAME);
 	switch (FileStatus) 
 	{
 		case EFileReadStatus::File_Not_Found : 
@@ -128,6 +138,51 @@ Tries to load the ISOGRAM file from the folder specified and reports on any erro
 }; // LoadWordList
 
 
+void AskForHostMode()
+/*
+Ask the user whether the game should play fair or play as an Evil host that avoids committing to a word
+Anything other than y/Y plays fair
+*/
+{
+	FText Response = "";
+	std::cout << "Play against the Evil host, who changes the word to dodge your guesses? (y/N): ";
+	std::getline(std::cin, Response);
+	if (Response[0] == 'y' || Response[0] == 'Y')
+	{
+		BCGame.SetHostMode(EHostMode::Evil);
+		std::cout << "Good luck...\n\n";
+	};
+	return;
+}; // AskForHostMode
+
+
+void AskForWordSelection()
+/*
+Ask the fair host's user which words they'd like to be picked from
+Anything not listed keeps every word equally likely (the Evil host doesn't pick a word so isn't asked)
+*/
+{
+	if (BCGame.GetHostMode() == EHostMode::Evil) { return; };
+	FText Response = "";
+	std::cout << "Which words should I pick from?\n";
+	std::cout << "  1 - Any word (default)\n";
+	std::cout << "  2 - Any word, but common words more often\n";
+	std::cout << "  3 - Common words only\n";
+	std::cout << "  4 - Hard words only\n";
+	std::cout << "Please enter a choice from above: ";
+	std::getline(std::cin, Response);
+	switch (Response[0])
+	{
+	case '2': BCGame.SetWordSelection(EWordSelection::Frequency_Weighted); break;
+	case '3': BCGame.SetWordSelection(EWordSelection::Common_Only); break;
+	case '4': BCGame.SetWordSelection(EWordSelection::Hard_Only); break;
+	default: BCGame.SetWordSelection(EWordSelection::Uniform); break;
+	};
+	std::cout << std::endl;
+	return;
+}; // AskForWordSelection
+
+
 int32 GetNumberOfLetters()
 /* 
 Ask the user for the number of letters in the isogram to try and guess
@@ -167,6 +222,7 @@ the word or they have run out of tries
 	std::cout << "  Number of letters: " << BCGame.GetHiddenWordLength() << std::endl;
 	std::cout << "  Maximum number of tries: " << BCGame.GetMaxTries() << std::endl;
 	std::cout << "  Dictionary size: " << BCGame.GetDictionarySize() << std::endl;
+	std::cout << "  (enter ? for a hint)" << std::endl;
 	std::cout << std::endl;
 	FText Guess = "";
 	int32 MaxTries = BCGame.GetMaxTries();
@@ -199,6 +255,13 @@ Get the guess from the user and report if it is invalid in any way
 		std::cout << "Try " << CurrentTry << " out of " << BCGame.GetMaxTries() << ". Enter your guess: ";
 		std::getline(std::cin, Guess);
 
+		if (Guess == "?")
+		{
+			// hints don't use up a try
+			std::cout << "Hint: " << BCGame.GetRemainingCandidateCount() << " possible word(s) left, try \"" << BCGame.GetHint() << "\"\n\n";
+			continue;
+		};
+
 		Status = BCGame.CheckGuessValidity(Guess);
 		switch (Status)
 		{
@@ -0,0 +1,71 @@
+/*
+Standalone differential check of the fast kernels against the reference implementations
+Exits non-zero on any mismatch so it can gate performance changes (perf_compare.sh runs it)
+
+Checks:
+- the loaded dictionary has the same words, in the same order and under the same word length, as the original loader
+- every (guess, word) pair of every word length in the isograms file (in parallel, see VerifyKernels)
+- a fixed set of random pairs of every length 1-8, drawn from alphabets that produce repeated letters,
+  upper case, punctuation and arbitrary bytes, so the non-isogram and fallback paths are covered too
+
+*/
+
+#include <iostream>
+#include <random>
+#include <string>
+#include "FBullCowGame.h"
+
+// to make syntax Unreal-friendly
+using int32 = int;
+
+
+// The entry-point for the check
+// usage: verify_kernels [isograms file] [random pairs]
+int main(int argc, char* argv[])
+{
+	FBullCowGame BCGame;
+	FKernelCheck Total;
+	if (argc > 1)
+	{
+		if (BCGame.LoadWordList(argv[1]) != EFileReadStatus::OK)
+		{
+			std::cout << "ERROR: Unable to load Isogram file: " << argv[1] << std::endl;
+			return 1;
+		};
+		Total = BCGame.VerifyWordList(argv[1]);
+		std::cout << "word list: checked=" << Total.Checked << " mismatches=" << Total.Mismatches << std::endl;
+		FKernelCheck DictionaryCheck = BCGame.VerifyKernels();
+		std::cout << "dictionary: checked=" << DictionaryCheck.Checked << " mismatches=" << DictionaryCheck.Mismatches << std::endl;
+		Total.Checked += DictionaryCheck.Checked;
+		Total.Mismatches += DictionaryCheck.Mismatches;
+	};
+
+	// fixed seed so every run checks the same pairs
+	int32 RandomPairs = (argc > 2) ? std::stoi(argv[2]) : 1000000;
+	const FString ALPHABETS[] = { "abcdefghijklmnopqrstuvwxyz", "abcde", "aAbB-/' ", FString() };
+	std::mt19937 RandomEngine(20261019);
+	std::uniform_int_distribution<int32> PickLength(1, 8);
+	std::uniform_int_distribution<int32> PickByte(0, 255);
+	FKernelCheck RandomCheck;
+	for (int32 Pair = 0; Pair < RandomPairs; Pair++)
+	{
+		const FString& Alphabet = ALPHABETS[Pair % 4];
+		int32 WordLen = PickLength(RandomEngine);
+		FString Guess(WordLen, ' ');
+		FString Word(WordLen, ' ');
+		for (int32 Chr = 0; Chr < WordLen; Chr++)
+		{
+			// an empty alphabet means any byte at all
+			Guess[Chr] = Alphabet.empty() ? static_cast<char>(PickByte(RandomEngine)) : Alphabet[PickByte(RandomEngine) % Alphabet.length()];
+			Word[Chr] = Alphabet.empty() ? static_cast<char>(PickByte(RandomEngine)) : Alphabet[PickByte(RandomEngine) % Alphabet.length()];
+		};
+		FKernelCheck PairCheck = BCGame.VerifyKernels(Guess, Word);
+		RandomCheck.Checked += PairCheck.Checked;
+		RandomCheck.Mismatches += PairCheck.Mismatches;
+		if (PairCheck.Mismatches > 0) { std::cout << "mismatch: guess \"" << Guess << "\" word \"" << Word << "\"\n"; };
+	};
+	std::cout << "random pairs: checked=" << RandomCheck.Checked << " mismatches=" << RandomCheck.Mismatches << std::endl;
+
+	Total.Mismatches += RandomCheck.Mismatches;
+	return (Total.Mismatches > 0) ? 1 : 0;
+}; // main
@@ -0,0 +1,186 @@
+#!/usr/bin/env bash
+#
+# Build presets for the Bulls and Cows game and a reproducible perf comparison between them
+#
+# usage:
+#   ./perf_compare.sh build <preset>   build the game, benchmark and kernel check with one preset
+#   ./perf_compare.sh compare [runs]   build every preset, check the kernels, run the benchmark under each and print a table
+#
+# presets:
+#   release        -O2
+#   lto            -O2 with link-time optimisation
+#   pgo-generate   -O2 instrumented to collect a profile (slow - only used for training)
+#   pgo-use        -O2 with LTO, optimised using the profile from a pgo-generate training run
+#
+# Environment:
+#   CXX       compiler to use (g++ or clang++, default g++)
+#   CXXFLAGS  extra flags added to every preset
+#   REPEATS   benchmark repeats per run (default 20)
+#
+# The PGO training workload (and the timed benchmark) is the headless game loop in benchmark.cpp
+# playing over isograms.txt. Builds go to _perf_build/<preset>/
+
+set -euo pipefail
+
+ROOT="$(cd "$(dirname "$0")" && pwd)"
+SOURCE_DIR="$ROOT/Bulls and Cows"
+BUILD_DIR="$ROOT/_perf_build"
+ISOGRAM_FILE="$ROOT/isograms.txt"
+CXX="${CXX:-g++}"
+CXXFLAGS="${CXXFLAGS:-}"
+REPEATS="${REPEATS:-20}"
+PRESETS="release lto pgo-generate pgo-use"
+PROFILE_DIR="$BUILD_DIR/profile"
+
+# shm_open is in librt on Linux (older glibc), and in libc on macOS which has no librt
+if [ "$(uname -s)" = Linux ]; then
+	LIBS="-lrt"
+else
+	LIBS=""
+fi
+
+if "$CXX" --version | grep -qi clang; then
+	COMPILER=clang
+else
+	COMPILER=gcc
+fi
+
+
+preset_flags()
+# compiler/linker flags for a preset
+{
+	case "$1" in
+		release)
+			echo "-O2 -DNDEBUG" ;;
+		lto)
+			echo "-O2 -DNDEBUG -flto" ;;
+		pgo-generate)
+			if [ "$COMPILER" = clang ]; then
+				echo "-O2 -DNDEBUG -fprofile-instr-generate=$PROFILE_DIR/bench-%p.profraw"
+			else
+				echo "-O2 -DNDEBUG -fprofile-generate -fprofile-update=atomic"
+			fi ;;
+		pgo-use)
+			if [ "$COMPILER" = clang ]; then
+				echo "-O2 -DNDEBUG -flto -fprofile-instr-use=$PROFILE_DIR/merged.profdata"
+			else
+				# only the benchmark is trained; the interactive game is waiting on the user so gets no profile
+				echo "-O2 -DNDEBUG -flto -fprofile-use -fprofile-correction -Wno-missing-profile"
+			fi ;;
+		*)
+			echo "Unknown preset: $1 (expected one of: $PRESETS)" >&2
+			exit 2 ;;
+	esac
+}
+
+
+build_preset()
+# build the game, the benchmark and the kernel check with one preset
+# pgo-use first (re)trains with pgo-generate so the profile always matches the current source
+{
+	local PRESET="$1"
+	local FLAGS
+	FLAGS="$(preset_flags "$PRESET") $CXXFLAGS"
+	if [ "$PRESET" = pgo-use ]; then
+		train_profile
+	fi
+	local OUT="$BUILD_DIR/$PRESET"
+	# gcc names profile data after the output path, so both PGO presets build in the same place
+	local WORK="$OUT"
+	case "$PRESET" in pgo-*) WORK="$PROFILE_DIR" ;; esac
+	mkdir -p "$OUT" "$WORK"
+	echo "Building $PRESET ($CXX $FLAGS)" >&2
+	# shellcheck disable=SC2086
+	"$CXX" -std=c++11 $FLAGS -pthread -o "$WORK/BullsAndCows" \
+		"$SOURCE_DIR/main.cpp" "$SOURCE_DIR/FBullCowGame.cpp" "$SOURCE_DIR/FHintCache.cpp" "$SOURCE_DIR/FSharedDictionary.cpp" $LIBS
+	# shellcheck disable=SC2086
+	"$CXX" -std=c++11 $FLAGS -pthread -o "$WORK/benchmark" \
+		"$SOURCE_DIR/benchmark.cpp" "$SOURCE_DIR/FBullCowGame.cpp" "$SOURCE_DIR/FHintCache.cpp" "$SOURCE_DIR/FSharedDictionary.cpp" $LIBS
+	# shellcheck disable=SC2086
+	"$CXX" -std=c++11 $FLAGS -pthread -o "$WORK/verify_kernels" \
+		"$SOURCE_DIR/verify_kernels.cpp" "$SOURCE_DIR/FBullCowGame.cpp" "$SOURCE_DIR/FHintCache.cpp" "$SOURCE_DIR/FSharedDictionary.cpp" $LIBS
+	if [ "$WORK" != "$OUT" ]; then
+		cp "$WORK/BullsAndCows" "$WORK/benchmark" "$WORK/verify_kernels" "$OUT/"
+	fi
+}
+
+
+train_profile()
+# build the instrumented benchmark, run the training workload and leave the profile in PROFILE_DIR
+{
+	rm -rf "$PROFILE_DIR"
+	mkdir -p "$PROFILE_DIR"
+	build_preset pgo-generate
+	echo "Training profile over $ISOGRAM_FILE" >&2
+	"$PROFILE_DIR/benchmark" "$ISOGRAM_FILE" 3 >/dev/null
+	if [ "$COMPILER" = clang ]; then
+		llvm-profdata merge -output="$PROFILE_DIR/merged.profdata" "$PROFILE_DIR"/*.profraw
+	fi
+}
+
+
+run_benchmark()
+# print the benchmark's elapsed milliseconds for one preset
+{
+	"$BUILD_DIR/$1/benchmark" "$ISOGRAM_FILE" "$REPEATS" | sed -n 's/.*elapsed_ms=\([0-9.]*\).*/\1/p'
+}
+
+
+median()
+# median of the numbers given as arguments
+{
+	printf '%s\n' "$@" | sort -g | awk '{ v[NR] = $1 } END { if (NR % 2) print v[(NR + 1) / 2]; else print (v[NR / 2] + v[NR / 2 + 1]) / 2 }'
+}
+
+
+compare()
+# build every preset then run the benchmark under each, interleaving presets so drift affects them all alike
+{
+	local RUNS="${1:-5}"
+	for PRESET in $PRESETS; do
+		# pgo-use builds (and trains) pgo-generate itself
+		[ "$PRESET" = pgo-generate ] || build_preset "$PRESET"
+	done
+
+	# timings of wrong answers are worthless, so every preset's kernels must match the reference first
+	for PRESET in $PRESETS; do
+		if ! "$BUILD_DIR/$PRESET/verify_kernels" "$ISOGRAM_FILE" >&2; then
+			echo "Kernel check failed for $PRESET" >&2
+			exit 1
+		fi
+	done
+
+	declare -A TIMES
+	for RUN in $(seq "$RUNS"); do
+		for PRESET in $PRESETS; do
+			TIMES[$PRESET]="${TIMES[$PRESET]:-} $(run_benchmark "$PRESET")"
+		done
+	done
+
+	local BASELINE
+	# shellcheck disable=SC2086
+	BASELINE="$(median ${TIMES[release]})"
+	echo
+	echo "$CXX, $RUNS runs x $REPEATS repeats of benchmark over $(basename "$ISOGRAM_FILE")"
+	printf '%-14s %12s %12s %12s %9s\n' preset "median ms" "min ms" "max ms" speedup
+	for PRESET in $PRESETS; do
+		local MEDIAN MIN MAX
+		# shellcheck disable=SC2086
+		MEDIAN="$(median ${TIMES[$PRESET]})"
+		MIN="$(printf '%s\n' ${TIMES[$PRESET]} | sort -g | head -1)"
+		MAX="$(printf '%s\n' ${TIMES[$PRESET]} | sort -g | tail -1)"
+		printf '%-14s %12.1f %12.1f %12.1f %8.2fx\n' "$PRESET" "$MEDIAN" "$MIN" "$MAX" \
+			"$(awk -v b="$BASELINE" -v m="$MEDIAN" 'BEGIN { print b / m }')"
+	done
+}
+
+
+case "${1:-}" in
+	build)
+		build_preset "${2:?preset required (one of: $PRESETS)}" ;;
+	compare)
+		compare "${2:-5}" ;;
+	*)
+		sed -n '3,20p' "$0" | sed 's/^# \{0,1\}//'
+		exit 2 ;;
+esac